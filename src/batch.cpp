@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "board.h"
+#include "boardmanage.h"
+
+using namespace std;
+
+//3BV never exceeds the number of safe cells
+#define HIST_SIZE (CELL_NUM*CELL_NUM+1)
+
+//mt19937 takes a 32 bit seed, so more boards would repeat seeds
+#define MAX_BOARD_NUM (1LL<<32)
+
+struct BatchResult {
+    vector<long long> bbbvHist;
+    long long openingSum;
+    long long islandSum;
+    long long pureColorSum;
+};
+
+//generate and score boards for seeds begin, begin+step, begin+2*step, ...
+void runBatch(long long begin, long long end, int step, BatchResult& result) {
+    Cursor cursor = {CELL_NUM/2, CELL_NUM/2};
+    Board board;
+    initBoard(board);
+
+    result.bbbvHist.assign(HIST_SIZE, 0);
+    result.openingSum = 0;
+    result.islandSum = 0;
+    result.pureColorSum = 0;
+
+    for (long long seed = begin; seed < end; seed += step) {
+        mt19937 gen(seed);
+        setCells(board, cursor, gen);
+        result.bbbvHist[board.metrics.bbbv]++;
+        result.openingSum += board.metrics.openingNum;
+        result.islandSum += board.metrics.islandNum;
+        result.pureColorSum += board.metrics.pureColorNum;
+    }
+}
+
+//ret true if str is a whole positive integer not larger than max
+bool parsePositive(const char* str, long long max, long long& value) {
+    char* end;
+    errno = 0;
+    value = strtoll(str, &end, 10);
+    return end != str && *end == '\0' && errno == 0 && value > 0 && value <= max;
+}
+
+//usage: batch.out [board num] [thread num]
+//print 3BV histogram as "<3BV> <count>" lines
+int main(int argc, char* argv[]) {
+    long long boardNum = 1000000;
+    long long threadNum = thread::hardware_concurrency();
+    if (threadNum <= 0) threadNum = 1;
+
+    if (argc > 3
+    || (argc > 1 && !parsePositive(argv[1], MAX_BOARD_NUM, boardNum))
+    || (argc > 2 && !parsePositive(argv[2], INT_MAX, threadNum))) {
+        cerr << "usage: batch.out [board num] [thread num]" << endl;
+        return 1;
+    }
+
+    //more threads than boards or cores only costs histograms and stacks
+    long long maxThreadNum = 4*max(1u, thread::hardware_concurrency());
+    threadNum = min(threadNum, min(boardNum, maxThreadNum));
+
+    vector<BatchResult> results(threadNum);
+    vector<thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        try {
+            threads.emplace_back(runBatch, t, boardNum, threadNum, ref(results[t]));
+        } catch (const system_error& e) {
+            cerr << "ERROR: cannot start thread in main(): " << e.what() << endl;
+            for (thread& th : threads) th.join();
+            return 1;
+        }
+    }
+    for (thread& th : threads) th.join();
+
+    BatchResult total = {vector<long long>(HIST_SIZE, 0), 0, 0, 0};
+    for (BatchResult& r : results) {
+        for (int i = 0; i < HIST_SIZE; i++) total.bbbvHist[i] += r.bbbvHist[i];
+        total.openingSum += r.openingSum;
+        total.islandSum += r.islandSum;
+        total.pureColorSum += r.pureColorSum;
+    }
+
+    cerr << "boards: " << boardNum
+         << ", avg openings: " << (double)total.openingSum/boardNum
+         << ", avg islands: " << (double)total.islandSum/boardNum
+         << ", avg pure color numbers: " << (double)total.pureColorSum/boardNum << endl;
+
+    for (int i = 0; i < HIST_SIZE; i++) {
+        if (total.bbbvHist[i]) cout << i << " " << total.bbbvHist[i] << "\n";
+    }
+
+    return 0;
+}
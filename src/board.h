@@ -1,13 +1,13 @@
 #ifndef BOARD_H
 #define BOARD_H
 
-#include <memory>
-#include <vector>
+#include <type_traits>
 
 #define CELL_NUM 10
 #define MINE_NUM 5
+#define EVENT_BUF_SIZE (CELL_NUM*CELL_NUM*2)
 
-enum class Color {
+enum class Color : unsigned char {
     NONE    = 0b000,
     RED     = 0b100,
     GREEN   = 0b010,
@@ -37,13 +37,68 @@ struct Cell {
     Color mineNumberColor;
 };
 
+struct BoardMetrics {
+    int bbbv;         //3BV: minimum number of clicks to open all safe cells
+    int openingNum;   //connected areas of blank cells
+    int islandNum;    //connected areas of numbered cells not next to an opening
+    int pureColorNum; //numbered cells whose color is only R, G or B
+};
+
+enum class EventType : unsigned char {
+    CELL,           //visible state of a cell changed
+    MINE_COUNTER,   //red/green/blue mine counter changed
+    REMAIN_COUNTER, //remaining cell counter changed
+    ACTION_END      //end of events from one openCell/setFlag/gameOver/gameClear
+};
+
+//CELL payload, revealed content is NONE/0 unless isOpened
+struct CellEvent {
+    int idx;                  //cell index (x*CELL_NUM+y)
+    bool isOpened;
+    bool isFlag;
+    Color flagColor;
+    Color mineColor;          //mine's color, NONE if not mine
+    Color mineNumberColor;    //mixed color of around mines
+    unsigned char mineNumber; //number of around mines
+};
+
+//MINE_COUNTER, REMAIN_COUNTER payload
+struct CounterEvent {
+    Color color; //MINE_COUNTER: counter's color, REMAIN_COUNTER: NONE
+    int value;   //new counter value
+};
+
+struct BoardEvent {
+    EventType type;
+    union {
+        CellEvent cell;
+        CounterEvent counter;
+    };
+};
+
+//fixed size ring buffer, drained by clients with popEvent()
+//if it overflows or initBoard() resets the board, isOverflow is set
+//(overflowed events are dropped), so the client should re-read
+//whole cells and call clearEvents()
+struct EventRing {
+    BoardEvent buf[EVENT_BUF_SIZE];
+    int head;
+    int size;
+    bool isOverflow;
+};
+
+//mines must leave at least the first opened cell safe
+static_assert(MINE_NUM*3 <= CELL_NUM*CELL_NUM-1, "too many mines for the board");
+
 struct Board{
-    std::unique_ptr<Cell[]> cells;
-    std::unique_ptr<std::vector<int>> mineIdxList;
+    Cell cells[CELL_NUM*CELL_NUM];
+    int mineIdxList[MINE_NUM*3];
     int redMineNum;
     int greenMineNum;
     int blueMineNum;
     int remainCellNum;
+    BoardMetrics metrics;
+    EventRing events;
 };
 
 #endif
\ No newline at end of file
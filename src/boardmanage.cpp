@@ -1,4 +1,4 @@
-#include <memory>
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <sstream>
@@ -6,18 +6,20 @@
 #include <random>
 
 #include "board.h"
+#include "boardmanage.h"
+#include "boardmetrics.h"
 #include "colortext.h"
 
 bool isOutOfBounds(int x, int y) {
     return x < 0 | x >= CELL_NUM | y < 0 | y >= CELL_NUM;
 }
 
-std::string getInfoString(std::shared_ptr<Board> board) {
+std::string getInfoString(Board& board) {
     std::ostringstream oss;
-    oss << redText("RED")     << ": " << std::to_string(board->redMineNum)   << ", ";
-    oss << greenText("GREEN") << ": " << std::to_string(board->greenMineNum) << ", ";
-    oss << blueText("BLUE")   << ": " << std::to_string(board->blueMineNum)  << ", ";
-    oss << "REMAINING MINES: " << std::to_string(board->remainCellNum) << "\n\r";
+    oss << redText("RED")     << ": " << std::to_string(board.redMineNum)   << ", ";
+    oss << greenText("GREEN") << ": " << std::to_string(board.greenMineNum) << ", ";
+    oss << blueText("BLUE")   << ": " << std::to_string(board.blueMineNum)  << ", ";
+    oss << "REMAINING MINES: " << std::to_string(board.remainCellNum) << "\n\r";
     return oss.str();
 }
 
@@ -101,7 +103,7 @@ std::string getHelpString() {
     return oss.str();
 }
 
-void printGameView(std::shared_ptr<Board> board, Cursor cursor, bool isHelp, bool isGameover) {
+void printGameView(Board& board, Cursor cursor, bool isHelp, bool isGameover) {
     if (isOutOfBounds(cursor.x, cursor.y)) {
         std::cerr << "ERROR: invalid index in printGameView()" << std::endl;
         exit(1);
@@ -130,9 +132,9 @@ void printGameView(std::shared_ptr<Board> board, Cursor cursor, bool isHelp, boo
 
         for (int j = 0; j < CELL_NUM; j++) {
             if (i == cursor.x && j == cursor.y) {
-                oss << " " << underlineText(getCellString(board->cells[i*CELL_NUM+j])) << " |";
+                oss << " " << underlineText(getCellString(board.cells[i*CELL_NUM+j])) << " |";
             } else {
-                oss << " " << getCellString(board->cells[i*CELL_NUM+j]) << " |";
+                oss << " " << getCellString(board.cells[i*CELL_NUM+j]) << " |";
             }
         }
         oss << "\n\r";
@@ -148,47 +150,67 @@ void printGameView(std::shared_ptr<Board> board, Cursor cursor, bool isHelp, boo
     std::cout << oss.str();
 }
 
-std::vector<int> generateMineIdxList(int x, int y) {
-    std::random_device seed;
-    std::mt19937 gen(seed());
-    std::vector<int> allIdxList;
+//pick MINE_NUM*3 cells except (x, y) into mineIdxList by partial shuffle
+//uses a scratch buffer on the stack, so no heap allocation
+void generateMineIdxList(int x, int y, std::mt19937& gen, int* mineIdxList) {
+    int allIdxList[CELL_NUM*CELL_NUM-1];
+    int allNum = 0;
     for (int i = 0; i < CELL_NUM*CELL_NUM; i++) {
-        if (i != x*CELL_NUM+y) allIdxList.push_back(i);
+        if (i != x*CELL_NUM+y) allIdxList[allNum++] = i;
     }
-    shuffle(allIdxList.begin(), allIdxList.end(), gen);
 
-    int mineNum = std::min(MINE_NUM*3, CELL_NUM*CELL_NUM);
+    for (int i = 0; i < MINE_NUM*3; i++) {
+        std::uniform_int_distribution<int> dist(i, allNum-1);
+        std::swap(allIdxList[i], allIdxList[dist(gen)]);
+        mineIdxList[i] = allIdxList[i];
+    }
+}
 
-    return std::vector<int> (allIdxList.begin(), allIdxList.begin()+mineNum);
+void generateMineIdxList(int x, int y, int* mineIdxList) {
+    std::random_device seed;
+    std::mt19937 gen(seed());
+    generateMineIdxList(x, y, gen, mineIdxList);
 }
 
-void setCells(std::shared_ptr<Board> board, Cursor cursor) {
+//overwrite board.cells in place
+void setCells(Board& board, Cursor cursor, std::mt19937& gen) {
     if (isOutOfBounds(cursor.x, cursor.y)) {
         std::cerr << "ERROR: invalid index in setCells()" << std::endl;
         exit(1);
     }
     
-    std::unique_ptr<Cell[]> cells = std::make_unique<Cell[]>(CELL_NUM*CELL_NUM);
+    Cell* cells = board.cells;
     
     //all cells initialize
     for(int i=0; i<CELL_NUM*CELL_NUM; i++) {
+        bool wasFlag = cells[i].isFlag;
         cells[i].mineColor = Color::NONE;
         cells[i].isOpened = false;
         cells[i].isFlag = false;
+        cells[i].flagColor = Color::NONE;
+        cells[i].mineNumber = 0;
+        cells[i].mineNumberColor = Color::NONE;
+
+        //flags placed before first open are removed
+        //these events join the batch of the following openCell()
+        if (wasFlag) pushCellEvent(board, i);
     }
 
-    std::vector<int> mineIdxList = generateMineIdxList(cursor.x, cursor.y);
+    generateMineIdxList(cursor.x, cursor.y, gen, board.mineIdxList);
     
     //for each of three colors, set MINE_NUM mines  
     int color_cnt=0;
     for (Color color: {Color::RED, Color::GREEN, Color::BLUE}) {
         for (int i = 0; i < MINE_NUM; i++) {
-            cells[mineIdxList[i+color_cnt*MINE_NUM]].mineColor = color;
+            cells[board.mineIdxList[i+color_cnt*MINE_NUM]].mineColor = color;
         }
         color_cnt++;
     }
 
-    board->mineIdxList = std::make_unique<std::vector<int>>(std::move(mineIdxList));
+    //metrics are accumulated in the same pass as numbers
+    MetricsScratch scratch;
+    initMetrics(scratch);
+    board.metrics = {0, 0, 0, 0};
 
     //if cell is not mine, set number and number's color
     for(int i=0; i<CELL_NUM*CELL_NUM; i++) {
@@ -211,99 +233,175 @@ void setCells(std::shared_ptr<Board> board, Cursor cursor) {
             cells[i].mineNumber = cnt;
             cells[i].mineNumberColor = color;
         }
+        accumulateMetrics(cells, i, scratch, board.metrics);
     }
+    finishMetrics(cells, scratch, board.metrics);
 
-    board->cells = std::move(cells);
+}
 
+void setCells(Board& board, Cursor cursor) {
+    std::random_device seed;
+    std::mt19937 gen(seed());
+    setCells(board, cursor, gen);
 }
 
-std::shared_ptr<Board> initBoard() {
+//reset board in place for a new game, no heap allocation
+//pending events are dropped and isOverflow is set
+void initBoard(Board& board) {
     Cursor dummy = {0, 0};
-    std::shared_ptr<Board> board_ptr = std::make_shared<Board>();
+
+    //start without events or flags, so setCells() pushes nothing
+    clearEvents(board);
+    for (int i = 0; i < CELL_NUM*CELL_NUM; i++) {
+        board.cells[i].isFlag = false;
+    }
 
     //set dummy cursor 
     //b/c need to print GameView before first open
-    setCells(board_ptr, dummy);
+    setCells(board, dummy);
+
+    board.redMineNum = MINE_NUM;
+    board.greenMineNum = MINE_NUM;
+    board.blueMineNum = MINE_NUM;
+    board.remainCellNum = CELL_NUM*CELL_NUM-MINE_NUM*3;
+
+    //clients may still show the previous game, so ask them to resync
+    board.events.isOverflow = true;
+}
+
+void clearEvents(Board& board) {
+    board.events.head = 0;
+    board.events.size = 0;
+    board.events.isOverflow = false;
+}
+
+void pushEvent(Board& board, BoardEvent event) {
+    EventRing& ring = board.events;
+    if (ring.size >= EVENT_BUF_SIZE) {
+        ring.isOverflow = true;
+        return;
+    }
+    ring.buf[(ring.head+ring.size)%EVENT_BUF_SIZE] = event;
+    ring.size++;
+}
+
+//push current visible state of cells[idx]
+void pushCellEvent(Board& board, int idx) {
+    const Cell& cell = board.cells[idx];
+    BoardEvent event;
+    event.type = EventType::CELL;
+    event.cell.idx = idx;
+    event.cell.isOpened = cell.isOpened;
+    event.cell.isFlag = cell.isFlag;
+    event.cell.flagColor = cell.flagColor;
+    if (cell.isOpened) {
+        event.cell.mineColor = cell.mineColor;
+        event.cell.mineNumberColor = cell.mineNumberColor;
+        event.cell.mineNumber = cell.mineNumber;
+    } else {
+        event.cell.mineColor = Color::NONE;
+        event.cell.mineNumberColor = Color::NONE;
+        event.cell.mineNumber = 0;
+    }
+    pushEvent(board, event);
+}
+
+void pushCounterEvent(Board& board, EventType type, Color color, int value) {
+    BoardEvent event;
+    event.type = type;
+    event.counter.color = color;
+    event.counter.value = value;
+    pushEvent(board, event);
+}
 
-    board_ptr->redMineNum = MINE_NUM;
-    board_ptr->greenMineNum = MINE_NUM;
-    board_ptr->blueMineNum = MINE_NUM;
-    board_ptr->remainCellNum = CELL_NUM*CELL_NUM-MINE_NUM*3;
+//mark the end of one action's events
+void pushActionEndEvent(Board& board) {
+    BoardEvent event;
+    event.type = EventType::ACTION_END;
+    pushEvent(board, event);
+}
 
-    return board_ptr;
+//ret true:event popped, false:no event
+bool popEvent(Board& board, BoardEvent& event) {
+    EventRing& ring = board.events;
+    if (ring.size <= 0) return false;
+    event = ring.buf[ring.head];
+    ring.head = (ring.head+1)%EVENT_BUF_SIZE;
+    ring.size--;
+    return true;
 }
 
-void operateMineNum(std::shared_ptr<Board> board, Color color, bool isIncrease) {
+void operateMineNum(Board& board, Color color, bool isIncrease) {
+    int* mineNum;
+    switch(color) {
+        case Color::RED:
+            mineNum = &board.redMineNum;
+            break;
+        case Color::GREEN:
+            mineNum = &board.greenMineNum;
+            break;
+        case Color::BLUE:
+            mineNum = &board.blueMineNum;
+            break;
+        default:
+            return;
+    }
+
     if (isIncrease) {
-        switch(color) {
-            case Color::RED:
-                board->redMineNum++;
-                break;
-            case Color::GREEN:
-                board->greenMineNum++;
-                break;
-            case Color::BLUE:
-                board->blueMineNum++;
-                break;
-            default:
-                break;
-        }
+        (*mineNum)++;
     } else {
-        switch(color) {
-            case Color::RED:
-                board->redMineNum--;
-                break;
-            case Color::GREEN:
-                board->greenMineNum--;
-                break;
-            case Color::BLUE:
-                board->blueMineNum--;
-                break;
-            default:
-                break;
-        }
+        (*mineNum)--;
     }
+
+    pushCounterEvent(board, EventType::MINE_COUNTER, color, *mineNum);
 }
 
-void setFlag(std::shared_ptr<Board> board, Cursor cursor, Color color) {
+void setFlag(Board& board, Cursor cursor, Color color) {
     if (isOutOfBounds(cursor.x, cursor.y)) {
         std::cerr << "ERROR: invalid index in setFlag()" << std::endl;
         exit(1);  
     }
 
-    if(board->cells[cursor.x*CELL_NUM+cursor.y].isFlag) {
+    if(board.cells[cursor.x*CELL_NUM+cursor.y].isFlag) {
         //if already flag exists, delete
-        if (color==board->cells[cursor.x*CELL_NUM+cursor.y].flagColor) {
-            board->cells[cursor.x*CELL_NUM+cursor.y].isFlag=false;
-            board->cells[cursor.x*CELL_NUM+cursor.y].flagColor=Color::NONE;
+        if (color==board.cells[cursor.x*CELL_NUM+cursor.y].flagColor) {
+            board.cells[cursor.x*CELL_NUM+cursor.y].isFlag=false;
+            board.cells[cursor.x*CELL_NUM+cursor.y].flagColor=Color::NONE;
+            pushCellEvent(board, cursor.x*CELL_NUM+cursor.y);
             operateMineNum(board, color, true);
         } else {
         //if another color flag exists, replace
-            operateMineNum(board, board->cells[cursor.x*CELL_NUM+cursor.y].flagColor, true);
-            board->cells[cursor.x*CELL_NUM+cursor.y].flagColor=color;
+            operateMineNum(board, board.cells[cursor.x*CELL_NUM+cursor.y].flagColor, true);
+            board.cells[cursor.x*CELL_NUM+cursor.y].flagColor=color;
+            pushCellEvent(board, cursor.x*CELL_NUM+cursor.y);
             operateMineNum(board, color, false);
         }
     } else {
         //if flag not exists, place a flag
-        if (!board->cells[cursor.x*CELL_NUM+cursor.y].isOpened) {
-            board->cells[cursor.x*CELL_NUM+cursor.y].isFlag=true;
-            board->cells[cursor.x*CELL_NUM+cursor.y].flagColor=color;
+        if (!board.cells[cursor.x*CELL_NUM+cursor.y].isOpened) {
+            board.cells[cursor.x*CELL_NUM+cursor.y].isFlag=true;
+            board.cells[cursor.x*CELL_NUM+cursor.y].flagColor=color;
+            pushCellEvent(board, cursor.x*CELL_NUM+cursor.y);
             operateMineNum(board, color, false);
         }
     }
+
+    pushActionEndEvent(board);
 }
 
-void openCellRecursive(std::shared_ptr<Board> board, int x, int y){
+//remainCellNum event is pushed once by the caller, not per cell
+void openCellRecursive(Board& board, int x, int y){
     for (int dx = -1; dx <= 1; dx++) {
         for (int dy = -1; dy <= 1; dy++) {
             if ((dx == 0 && dy == 0) || isOutOfBounds(x+dx, y+dy)) continue;
             
-            if(!board->cells[(x+dx)*CELL_NUM+y+dy].isFlag
-            && !board->cells[(x+dx)*CELL_NUM+y+dy].isOpened 
-            &&  board->cells[(x+dx)*CELL_NUM+y+dy].mineColor == Color::NONE) {
-                board->cells[(x+dx)*CELL_NUM+y+dy].isOpened = true;
-                board->remainCellNum--;
-                if (board->cells[(x+dx)*CELL_NUM+y+dy].mineNumber == 0) openCellRecursive(board, x+dx, y+dy); 
+            if(!board.cells[(x+dx)*CELL_NUM+y+dy].isFlag
+            && !board.cells[(x+dx)*CELL_NUM+y+dy].isOpened 
+            &&  board.cells[(x+dx)*CELL_NUM+y+dy].mineColor == Color::NONE) {
+                board.cells[(x+dx)*CELL_NUM+y+dy].isOpened = true;
+                board.remainCellNum--;
+                pushCellEvent(board, (x+dx)*CELL_NUM+y+dy);
+                if (board.cells[(x+dx)*CELL_NUM+y+dy].mineNumber == 0) openCellRecursive(board, x+dx, y+dy); 
             }
         }
     }
@@ -311,29 +409,34 @@ void openCellRecursive(std::shared_ptr<Board> board, int x, int y){
 
 //open cells using openCellRecursive(), 
 //ret 0:notmine, 1:mine
-int openCell(std::shared_ptr<Board> board, Cursor cursor){
+int openCell(Board& board, Cursor cursor){
     if (isOutOfBounds(cursor.x, cursor.y)) {
         std::cerr << "ERROR: invalid index in openCell()" << std::endl;
         exit(1);  
     }
 
     //cannot open the flag cell or already opened cell
-    if (!board->cells[cursor.x*CELL_NUM+cursor.y].isFlag
-      &&!board->cells[cursor.x*CELL_NUM+cursor.y].isOpened) {
+    if (!board.cells[cursor.x*CELL_NUM+cursor.y].isFlag
+      &&!board.cells[cursor.x*CELL_NUM+cursor.y].isOpened) {
 
         //if mine cell opened
-        if (board->cells[cursor.x*CELL_NUM+cursor.y].mineColor!=Color::NONE) {
+        if (board.cells[cursor.x*CELL_NUM+cursor.y].mineColor!=Color::NONE) {
+            pushActionEndEvent(board);
             return 1;
         }
 
-        board->cells[cursor.x*CELL_NUM+cursor.y].isOpened = true;
-        board->remainCellNum--;
+        board.cells[cursor.x*CELL_NUM+cursor.y].isOpened = true;
+        board.remainCellNum--;
+        pushCellEvent(board, cursor.x*CELL_NUM+cursor.y);
 
         //if opened cell was blanc, open recursively
-        if (!board->cells[cursor.x*CELL_NUM+cursor.y].mineNumber) {
+        if (!board.cells[cursor.x*CELL_NUM+cursor.y].mineNumber) {
             openCellRecursive(board, cursor.x, cursor.y);
         }
+
+        pushCounterEvent(board, EventType::REMAIN_COUNTER, Color::NONE, board.remainCellNum);
     }
 
+    pushActionEndEvent(board);
     return 0;
 }
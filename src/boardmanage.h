@@ -1,30 +1,38 @@
 #ifndef BOARDMANAGE_H
 #define BOARDMANAGE_H
 
-#include <memory>
+#include <random>
 #include <string>
-#include <vector>
 
 #include "board.h"
 
 bool isOutOfBounds(int x, int y);
 
-std::string getInfoString(std::shared_ptr<Board> board);
+std::string getInfoString(Board& board);
 std::string getNumberString(Cell cell);
 std::string getCellString(Cell cell);
 std::string getHelpString();
 
-void printGameView(std::shared_ptr<Board> board, Cursor cursor, bool isHelp, bool isGameover);
+void printGameView(Board& board, Cursor cursor, bool isHelp, bool isGameover);
 
-std::vector<int> generateMineIdxList(int x, int y);
-void setCells(std::shared_ptr<Board> board, Cursor cursor);
+void generateMineIdxList(int x, int y, std::mt19937& gen, int* mineIdxList);
+void generateMineIdxList(int x, int y, int* mineIdxList);
+void setCells(Board& board, Cursor cursor, std::mt19937& gen);
+void setCells(Board& board, Cursor cursor);
 
-std::shared_ptr<Board> initBoard();
+void initBoard(Board& board);
 
-void operateMineNum(std::shared_ptr<Board> board, Color color, bool isIncrease);
-void setFlag(std::shared_ptr<Board> board, Cursor cursor, Color color);
+void clearEvents(Board& board);
+void pushEvent(Board& board, BoardEvent event);
+void pushCellEvent(Board& board, int idx);
+void pushCounterEvent(Board& board, EventType type, Color color, int value);
+void pushActionEndEvent(Board& board);
+bool popEvent(Board& board, BoardEvent& event);
 
-void openCellRecursive(std::shared_ptr<Board> board, int x, int y);
-int openCell(std::shared_ptr<Board> board, Cursor cursor);
+void operateMineNum(Board& board, Color color, bool isIncrease);
+void setFlag(Board& board, Cursor cursor, Color color);
+
+void openCellRecursive(Board& board, int x, int y);
+int openCell(Board& board, Cursor cursor);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "board.h"
+#include "boardmanage.h"
+#include "boardmetrics.h"
+
+int findRoot(int* parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+void uniteRoot(int* parent, int a, int b) {
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if (a < b) parent[b] = a;
+    else if (b < a) parent[a] = b;
+}
+
+void initMetrics(MetricsScratch& scratch) {
+    for (int i = 0; i < CELL_NUM*CELL_NUM; i++) {
+        scratch.parent[i] = i;
+        scratch.isBordered[i] = false;
+    }
+}
+
+//called from setCells() right after cells[i].mineNumber is set,
+//so cells before i already have their number
+void accumulateMetrics(const Cell* cells, int i, MetricsScratch& scratch, BoardMetrics& metrics) {
+    if (cells[i].mineColor != Color::NONE) return;
+
+    if (cells[i].mineNumber != 0) {
+        switch(cells[i].mineNumberColor) {
+            case Color::RED:
+            case Color::GREEN:
+            case Color::BLUE:
+                metrics.pureColorNum++;
+                break;
+            default:
+                break;
+        }
+        return;
+    }
+
+    //blank cell: join previous blank neighbors, mark all neighbors as bordered
+    int x = i/CELL_NUM, y = i%CELL_NUM;
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            if ((dx == 0 && dy == 0) || isOutOfBounds(x+dx, y+dy)) continue;
+            int j = (x+dx)*CELL_NUM+(y+dy);
+            scratch.isBordered[j] = true;
+            if (j < i && cells[j].mineColor == Color::NONE && cells[j].mineNumber == 0) {
+                uniteRoot(scratch.parent, i, j);
+            }
+        }
+    }
+}
+
+//count openings and islands, then 3BV = openings + numbered cells not next to an opening
+void finishMetrics(const Cell* cells, MetricsScratch& scratch, BoardMetrics& metrics) {
+    int isolatedNum = 0;
+
+    for (int i = 0; i < CELL_NUM*CELL_NUM; i++) {
+        if (cells[i].mineColor != Color::NONE) continue;
+
+        if (cells[i].mineNumber == 0) {
+            if (findRoot(scratch.parent, i) == i) metrics.openingNum++;
+            continue;
+        }
+        if (scratch.isBordered[i]) continue;
+
+        isolatedNum++;
+        int x = i/CELL_NUM, y = i%CELL_NUM;
+        for (int dx = -1; dx <= 0; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                if ((dx == 0 && dy >= 0) || isOutOfBounds(x+dx, y+dy)) continue;
+                int j = (x+dx)*CELL_NUM+(y+dy);
+                if (cells[j].mineColor == Color::NONE && cells[j].mineNumber != 0
+                 && !scratch.isBordered[j]) {
+                    uniteRoot(scratch.parent, i, j);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < CELL_NUM*CELL_NUM; i++) {
+        if (cells[i].mineColor == Color::NONE && cells[i].mineNumber != 0
+         && !scratch.isBordered[i] && findRoot(scratch.parent, i) == i) {
+            metrics.islandNum++;
+        }
+    }
+
+    metrics.bbbv = metrics.openingNum + isolatedNum;
+}
@@ -0,0 +1,19 @@
+#ifndef BOARDMETRICS_H
+#define BOARDMETRICS_H
+
+#include "board.h"
+
+//work area for union-find, lives on the stack of setCells()
+struct MetricsScratch {
+    int parent[CELL_NUM*CELL_NUM];
+    bool isBordered[CELL_NUM*CELL_NUM]; //next to a blank cell
+};
+
+int findRoot(int* parent, int i);
+void uniteRoot(int* parent, int a, int b);
+
+void initMetrics(MetricsScratch& scratch);
+void accumulateMetrics(const Cell* cells, int i, MetricsScratch& scratch, BoardMetrics& metrics);
+void finishMetrics(const Cell* cells, MetricsScratch& scratch, BoardMetrics& metrics);
+
+#endif
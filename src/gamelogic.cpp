@@ -1,35 +1,41 @@
-#include <memory>
 #include <iostream>
 
 #include "board.h"
 #include "boardmanage.h"
 
-bool getIsGameclear(std::shared_ptr<Board> board) {
+bool getIsGameclear(Board& board) {
     bool isClear = true;
-    for(int idx : *board->mineIdxList) {
+    for(int idx : board.mineIdxList) {
         if (!isClear) break;
-        isClear &= board->cells[idx].flagColor == board->cells[idx].mineColor;
+        isClear &= board.cells[idx].flagColor == board.cells[idx].mineColor;
     }
-    return isClear && board->remainCellNum<=0;
+    return isClear && board.remainCellNum<=0;
 }
 
-void gameOver(std::shared_ptr<Board> board, Cursor cursor) {
-    for(int idx: (*board->mineIdxList)) {
-        if (board->cells[idx].isFlag) {
-            board->cells[idx].flagColor = board->cells[idx].mineColor;
+void gameOver(Board& board, Cursor cursor) {
+    for(int idx: board.mineIdxList) {
+        if (board.cells[idx].isFlag) {
+            if (board.cells[idx].flagColor == board.cells[idx].mineColor) continue;
+            board.cells[idx].flagColor = board.cells[idx].mineColor;
         } else {
-            board->cells[idx].isOpened = true;
+            if (board.cells[idx].isOpened) continue;
+            board.cells[idx].isOpened = true;
         }
+        pushCellEvent(board, idx);
     }
+    pushActionEndEvent(board);
     system("clear");
     printGameView(board, cursor, false, false);
     std::cout << "GAMEOVER!\n\r";
 }
 
-void gameClear(std::shared_ptr<Board> board, Cursor cursor) {
+void gameClear(Board& board, Cursor cursor) {
     for (int i=0; i<CELL_NUM*CELL_NUM; i++) {
-        board->cells[i].isOpened = true;
+        if (board.cells[i].isOpened) continue;
+        board.cells[i].isOpened = true;
+        pushCellEvent(board, i);
     }
+    pushActionEndEvent(board);
     system("clear");
     printGameView(board, cursor, false, false);
     std::cout << "CONGRATULATIONS!\n\r";
@@ -35,7 +35,8 @@ int main(void) {
     bool isLoop = true, isFirst = true, isCancel = false, isHelp = false;
 
     Cursor cursor = {0, 0};
-    shared_ptr<Board> board = initBoard();
+    Board board;
+    initBoard(board);
 
     enableRawMode();
 